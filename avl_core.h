@@ -0,0 +1,400 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <algorithm>
+#include <iostream>
+
+#include "perf_stats.h"
+#include "snapshot.h"
+
+namespace avl_core {
+
+using namespace std;
+
+struct Node {
+    int key;
+    int height;
+    Node* left;
+    Node* right;
+
+    Node(int k) : key(k), height(1), left(nullptr), right(nullptr) {}
+};
+
+struct LogStep {
+    string action; // "search_visit", "insert_node", "highlight_node", "rotate_event", "update_stats"
+    int key;
+    string info; 
+};
+
+struct NodeData {
+    int key;
+    int height;
+    int bf;
+    int leftKey;  // -1 if null
+    int rightKey; // -1 if null
+};
+
+struct Stats {
+    double comparisons; // one per node visited on an insert/remove path
+    double rotations;
+    double allocations; // nodes allocated since the last reset
+    double bytesLive;   // node memory currently held by the tree
+    perf::CallTiming timing;
+};
+
+// One node of a snapshot arena. Nodes are stored in preorder with the root at
+// index 0, so every child index is greater than its parent's.
+struct ArenaNode {
+    int32_t key;
+    int32_t height;
+    int32_t left;  // -1 if null
+    int32_t right; // -1 if null
+};
+
+static_assert(sizeof(ArenaNode) == 4 * sizeof(int32_t), "arena nodes must be packed int32s");
+
+// Checks that an arena is a valid AVL tree rooted at index 0: every node is
+// reached exactly once, keys are in BST order, every node is balanced and
+// every stored height is correct. Balance keeps the depth O(log n), which the
+// recursive insert/remove rely on.
+inline bool validArena(const ArenaNode* nodes, int32_t count) {
+    vector<char> referenced(count, 0);
+    for (int32_t i = 0; i < count; i++) {
+        for (int32_t child : {nodes[i].left, nodes[i].right}) {
+            if (child == -1) continue;
+            if (child <= i || child >= count || referenced[child]) return false;
+            referenced[child] = 1;
+        }
+    }
+    for (int32_t i = 1; i < count; i++) {
+        if (!referenced[i]) return false;
+    }
+
+    // Children sit after their parent, so a reverse sweep sees them first.
+    vector<int32_t> minKey(count), maxKey(count);
+    for (int32_t i = count - 1; i >= 0; i--) {
+        const ArenaNode& n = nodes[i];
+        int32_t hl = 0, hr = 0;
+        minKey[i] = maxKey[i] = n.key;
+        if (n.left != -1) {
+            if (maxKey[n.left] >= n.key) return false;
+            minKey[i] = minKey[n.left];
+            hl = nodes[n.left].height;
+        }
+        if (n.right != -1) {
+            if (minKey[n.right] <= n.key) return false;
+            maxKey[i] = maxKey[n.right];
+            hr = nodes[n.right].height;
+        }
+        if (hl - hr > 1 || hr - hl > 1) return false;
+        if (n.height != 1 + max(hl, hr)) return false;
+    }
+    return true;
+}
+
+// Read-only view over an AVL snapshot, usable straight from an mmap'd file.
+struct ArenaView {
+    const ArenaNode* nodes;
+    int32_t count;
+
+    bool contains(int key) const {
+        int32_t i = count > 0 ? 0 : -1;
+        while (i != -1) {
+            if (key == nodes[i].key) return true;
+            i = key < nodes[i].key ? nodes[i].left : nodes[i].right;
+        }
+        return false;
+    }
+};
+
+inline bool openArena(const uint8_t* data, size_t len, ArenaView& out) {
+    const snapshot::Header* h = snapshot::validate(data, len, snapshot::AVL_ARENA);
+    if (h == nullptr || snapshot::payloadInts(h) < 1) return false;
+    const int32_t* p = snapshot::payload(h);
+    int32_t count = p[0];
+    // 64-bit arithmetic: size_t is 32 bits on wasm and count comes from the buffer.
+    if (count < 0 || snapshot::payloadInts(h) != 1 + (uint64_t)count * 4) return false;
+    const ArenaNode* nodes = reinterpret_cast<const ArenaNode*>(p + 1);
+    if (!validArena(nodes, count)) return false;
+    out.nodes = nodes;
+    out.count = count;
+    return true;
+}
+
+class AVLBackend {
+private:
+    Node* root;
+    vector<LogStep> logs; 
+    Stats stats;
+    int liveNodes;
+    bool timingEnabled;
+
+    int height(Node* N) {
+        if (N == nullptr) return 0;
+        return N->height;
+    }
+
+    int getBalance(Node* N) {
+        if (N == nullptr) return 0;
+        return height(N->left) - height(N->right);
+    }
+
+    void updateHeight(Node* N) {
+        if (N != nullptr)
+            N->height = 1 + max(height(N->left), height(N->right));
+    }
+
+    Node* rightRotate(Node* y) {
+        stats.rotations++;
+        logs.push_back({"rotate_event", y->key, "Performing Right Rotate (LL Case)"});
+        Node* x = y->left;
+        Node* T2 = x->right;
+
+        x->right = y;
+        y->left = T2;
+
+        updateHeight(y);
+        updateHeight(x);
+
+        return x;
+    }
+
+    Node* leftRotate(Node* x) {
+        stats.rotations++;
+        logs.push_back({"rotate_event", x->key, "Performing Left Rotate (RR Case)"});
+        Node* y = x->right;
+        Node* T2 = y->left;
+
+        y->left = x;
+        x->right = T2;
+
+        updateHeight(x);
+        updateHeight(y);
+
+        return y;
+    }
+
+
+    Node* insertNode(Node* node, int key) {
+        if (node == nullptr) {
+            logs.push_back({"insert_node", key, "Inserted"});
+            stats.allocations++;
+            liveNodes++;
+            return new Node(key);
+        }
+
+        logs.push_back({"search_visit", node->key, ""}); // Visualizing the path
+        stats.comparisons++;
+
+        if (key < node->key)
+            node->left = insertNode(node->left, key);
+        else if (key > node->key)
+            node->right = insertNode(node->right, key);
+        else 
+            return node;
+
+        updateHeight(node);
+
+        int balance = getBalance(node);
+        logs.push_back({"update_stats", node->key, "H:" + to_string(node->height) + " BF:" + to_string(balance)});
+
+        if (balance > 1 && key < node->left->key)
+            return rightRotate(node);
+
+        if (balance < -1 && key > node->right->key)
+            return leftRotate(node);
+
+        if (balance > 1 && key > node->left->key) {
+            logs.push_back({"rotate_event", node->left->key, "Left Rotate (LR Prep)"});
+            node->left = leftRotate(node->left);
+            return rightRotate(node);
+        }
+
+        if (balance < -1 && key < node->right->key) {
+            logs.push_back({"rotate_event", node->right->key, "Right Rotate (RL Prep)"});
+            node->right = rightRotate(node->right);
+            return leftRotate(node);
+        }
+
+        return node;
+    }
+
+    Node* minValueNode(Node* node) {
+        Node* current = node;
+        while (current->left != nullptr)
+            current = current->left;
+        return current;
+    }
+
+    Node* deleteNode(Node* root, int key) {
+        if (root == nullptr) return root;
+
+        logs.push_back({"search_visit", root->key, ""});
+        stats.comparisons++;
+
+        if (key < root->key)
+            root->left = deleteNode(root->left, key);
+        else if (key > root->key)
+            root->right = deleteNode(root->right, key);
+        else {
+            // Node found
+            if ((root->left == nullptr) || (root->right == nullptr)) {
+                Node* temp = root->left ? root->left : root->right;
+                if (temp == nullptr) {
+                    temp = root;
+                    root = nullptr;
+                } else
+                    *root = *temp;
+                delete temp;
+                liveNodes--;
+                logs.push_back({"insert_node", key, "Deleted"});
+            } else {
+                Node* temp = minValueNode(root->right);
+                root->key = temp->key;
+                logs.push_back({"highlight_node", root->key, "Replaced with Successor"});
+                root->right = deleteNode(root->right, temp->key);
+            }
+        }
+
+        if (root == nullptr) return root;
+
+        updateHeight(root);
+        int balance = getBalance(root);
+        logs.push_back({"update_stats", root->key, "H:" + to_string(root->height) + " BF:" + to_string(balance)});
+
+        if (balance > 1 && getBalance(root->left) >= 0)
+            return rightRotate(root);
+
+        if (balance > 1 && getBalance(root->left) < 0) {
+            root->left = leftRotate(root->left);
+            return rightRotate(root);
+        }
+
+        if (balance < -1 && getBalance(root->right) <= 0)
+            return leftRotate(root);
+
+        if (balance < -1 && getBalance(root->right) > 0) {
+            root->right = rightRotate(root->right);
+            return leftRotate(root);
+        }
+
+        return root;
+    }
+
+    void destroy(Node* node) {
+        if (node == nullptr) return;
+        destroy(node->left);
+        destroy(node->right);
+        delete node;
+    }
+
+    int32_t flatten(Node* node, vector<ArenaNode>& arena) {
+        if (node == nullptr) return -1;
+        int32_t at = arena.size();
+        arena.push_back({node->key, node->height, -1, -1});
+        int32_t l = flatten(node->left, arena);
+        int32_t r = flatten(node->right, arena);
+        arena[at].left = l;
+        arena[at].right = r;
+        return at;
+    }
+
+    void serialize(Node* node, vector<NodeData>& out) {
+        if (node == nullptr) return;
+        NodeData d;
+        d.key = node->key;
+        d.height = node->height;
+        d.bf = getBalance(node);
+        d.leftKey = (node->left) ? node->left->key : -1;
+        d.rightKey = (node->right) ? node->right->key : -1;
+        out.push_back(d);
+        
+        serialize(node->left, out);
+        serialize(node->right, out);
+    }
+
+public:
+    AVLBackend() : root(nullptr), stats(), liveNodes(0), timingEnabled(false) {}
+
+    ~AVLBackend() {
+        destroy(root);
+    }
+
+    vector<LogStep> insert(int key) {
+        perf::ScopedCallTimer timer(stats.timing, timingEnabled);
+        logs.clear();
+        root = insertNode(root, key);
+        return logs;
+    }
+
+    vector<LogStep> remove(int key) {
+        perf::ScopedCallTimer timer(stats.timing, timingEnabled);
+        logs.clear();
+        root = deleteNode(root, key);
+        return logs;
+    }
+
+    vector<NodeData> getTreeStructure() {
+        vector<NodeData> out;
+        serialize(root, out);
+        return out;
+    }
+
+    vector<uint8_t> saveSnapshot() {
+        vector<ArenaNode> arena;
+        arena.reserve(liveNodes);
+        flatten(root, arena);
+
+        snapshot::Writer w;
+        w.reserve(1 + arena.size() * 4);
+        w.put((int32_t)arena.size());
+        for (const ArenaNode& n : arena) {
+            w.put(n.key);
+            w.put(n.height);
+            w.put(n.left);
+            w.put(n.right);
+        }
+        return w.finish(snapshot::AVL_ARENA, 0);
+    }
+
+    // Replaces the tree with the snapshot's. Leaves the tree untouched and
+    // returns false if the buffer is not a valid AVL snapshot.
+    bool loadSnapshot(const uint8_t* data, size_t len) {
+        ArenaView view;
+        if (!openArena(data, len, view)) return false;
+
+        vector<Node*> nodes(view.count);
+        for (int32_t i = 0; i < view.count; i++) nodes[i] = new Node(view.nodes[i].key);
+        // openArena() has already checked the stored heights.
+        for (int32_t i = 0; i < view.count; i++) {
+            const ArenaNode& a = view.nodes[i];
+            nodes[i]->height = a.height;
+            nodes[i]->left = a.left == -1 ? nullptr : nodes[a.left];
+            nodes[i]->right = a.right == -1 ? nullptr : nodes[a.right];
+        }
+
+        destroy(root);
+        root = view.count > 0 ? nodes[0] : nullptr;
+        liveNodes = view.count;
+        stats.allocations += view.count;
+        return true;
+    }
+
+    Stats getStats() {
+        Stats s = stats;
+        s.bytesLive = (double)liveNodes * sizeof(Node);
+        return s;
+    }
+
+    void resetStats() {
+        stats = Stats();
+    }
+
+    void setTiming(bool enabled) {
+        timingEnabled = enabled;
+    }
+};
+
+} // namespace avl_core
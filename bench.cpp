@@ -0,0 +1,317 @@
+// Native benchmark for the four backends. Builds without emscripten:
+//
+//     g++ -O2 -std=c++17 bench.cpp -o bench
+//     ./bench [size ...] > bench.json
+//
+// Every backend is driven through its public API (so the LogStep traces the
+// frontends consume are part of the measured cost) across several sizes and
+// key distributions. Results go to stdout as JSON, progress to stderr.
+
+#include "avl_core.h"
+#include "heap_core.h"
+#include "graph_core.h"
+#include "hash_core.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// ---- memory accounting ---------------------------------------------------
+// Every global allocation carries a small header with its size so we can
+// report the bytes a structure keeps alive after it has been built.
+
+static size_t g_bytesLive = 0;
+static size_t g_allocCount = 0;
+
+static const size_t ALLOC_HEADER = 16;
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    void* p = malloc(size + ALLOC_HEADER);
+    if (p == nullptr) throw bad_alloc();
+    *static_cast<size_t*>(p) = size;
+    g_bytesLive += size;
+    g_allocCount++;
+    return static_cast<char*>(p) + ALLOC_HEADER;
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    if (p == nullptr) return;
+    char* base = static_cast<char*>(p) - ALLOC_HEADER;
+    g_bytesLive -= *reinterpret_cast<size_t*>(base);
+    free(base);
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { operator delete(p); }
+
+// ---- timing --------------------------------------------------------------
+
+typedef chrono::steady_clock Clock;
+
+struct Result {
+    string backend;
+    string op;
+    string dist;
+    int n;
+    vector<double> samplesNs;
+};
+
+struct Footprint {
+    string backend;
+    string dist;
+    int n;
+    size_t bytesLive;
+    size_t allocations;
+};
+
+static deque<Result> g_results; // deque: references stay valid as results are added
+static vector<Footprint> g_footprints;
+
+template <typename F>
+static double timeNs(F&& f) {
+    auto t0 = Clock::now();
+    f();
+    auto t1 = Clock::now();
+    return chrono::duration<double, nano>(t1 - t0).count();
+}
+
+static Result& newResult(const string& backend, const string& op, const string& dist, int n, int samples) {
+    g_results.push_back({backend, op, dist, n, {}});
+    g_results.back().samplesNs.reserve(samples);
+    return g_results.back();
+}
+
+static void recordFootprint(const string& backend, const string& dist, int n,
+                            size_t bytesBefore, size_t allocsBefore) {
+    g_footprints.push_back({backend, dist, n, g_bytesLive - bytesBefore, g_allocCount - allocsBefore});
+}
+
+// ---- key distributions ---------------------------------------------------
+
+static const char* DISTRIBUTIONS[] = {"sequential", "reverse", "random"};
+
+static vector<int> makeKeys(const string& dist, int n) {
+    vector<int> keys(n);
+    for (int i = 0; i < n; i++) keys[i] = i;
+    if (dist == "reverse") {
+        reverse(keys.begin(), keys.end());
+    } else if (dist == "random") {
+        mt19937 rng(12345);
+        shuffle(keys.begin(), keys.end(), rng);
+    }
+    return keys;
+}
+
+// ---- per-backend workloads -----------------------------------------------
+
+static const int SNAPSHOT_REPS = 3;
+
+// Saves the built structure and restores it into a fresh backend, the
+// alternative to replaying every insert.
+template <typename Backend>
+static void benchSnapshot(const string& backend, const string& dist, int n, Backend& built) {
+    Result& save = newResult(backend, "snapshot_save", dist, n, SNAPSHOT_REPS);
+    Result& load = newResult(backend, "snapshot_load", dist, n, SNAPSHOT_REPS);
+    for (int r = 0; r < SNAPSHOT_REPS; r++) {
+        vector<uint8_t> bytes;
+        save.samplesNs.push_back(timeNs([&] { bytes = built.saveSnapshot(); }));
+        Backend restored;
+        bool ok = true;
+        load.samplesNs.push_back(timeNs([&] { ok = restored.loadSnapshot(bytes.data(), bytes.size()); }));
+        if (!ok) {
+            fprintf(stderr, "%s: snapshot failed to load\n", backend.c_str());
+            exit(1);
+        }
+    }
+}
+
+static void benchAVL(const string& dist, const vector<int>& keys) {
+    int n = keys.size();
+    Result& ins = newResult("avl", "insert", dist, n, n);
+    size_t bytesBefore = g_bytesLive, allocsBefore = g_allocCount;
+    {
+        avl_core::AVLBackend avl;
+
+        for (int k : keys) ins.samplesNs.push_back(timeNs([&] { avl.insert(k); }));
+
+        recordFootprint("avl", dist, n, bytesBefore, allocsBefore);
+        benchSnapshot("avl", dist, n, avl);
+
+        Result& del = newResult("avl", "delete", dist, n, n);
+        for (int k : keys) del.samplesNs.push_back(timeNs([&] { avl.remove(k); }));
+    }
+}
+
+static void benchHeap(const string& dist, const vector<int>& keys) {
+    int n = keys.size();
+    Result& ins = newResult("heap", "insert", dist, n, n);
+    size_t bytesBefore = g_bytesLive, allocsBefore = g_allocCount;
+    {
+        heap_core::HeapBackend heap;
+
+        for (int k : keys) ins.samplesNs.push_back(timeNs([&] { heap.insert(k); }));
+
+        recordFootprint("heap", dist, n, bytesBefore, allocsBefore);
+        benchSnapshot("heap", dist, n, heap);
+
+        Result& ext = newResult("heap", "extract", dist, n, n);
+        for (int i = 0; i < n; i++) ext.samplesNs.push_back(timeNs([&] { heap.extract(); }));
+    }
+}
+
+static void benchHash(const string& dist, const vector<int>& keys) {
+    int n = keys.size();
+    Result& ins = newResult("hash", "insert", dist, n, n);
+    size_t bytesBefore = g_bytesLive, allocsBefore = g_allocCount;
+    {
+        hash_core::HashTableBackend table;
+
+        for (int k : keys) ins.samplesNs.push_back(timeNs([&] { table.insert(k); }));
+
+        recordFootprint("hash", dist, n, bytesBefore, allocsBefore);
+        benchSnapshot("hash", dist, n, table);
+
+        Result& hit = newResult("hash", "search", dist, n, n);
+        for (int k : keys) hit.samplesNs.push_back(timeNs([&] { table.search(k); }));
+
+        Result& miss = newResult("hash", "search_miss", dist, n, n);
+        for (int k : keys) miss.samplesNs.push_back(timeNs([&] { table.search(k + n); }));
+    }
+}
+
+// Each vertex gets an edge to its successor in key order (so the graph is
+// connected) plus two random extra edges.
+static const int GRAPH_EXTRA_EDGES = 2;
+static const int GRAPH_TRAVERSAL_REPS = 3;
+static const int GRAPH_MAX_REMOVALS = 200;
+static const int TRACE_PAGE = 64;
+
+static void benchGraph(const string& dist, const vector<int>& keys) {
+    int n = keys.size();
+    Result& ins = newResult("graph", "add_edge", dist, n, n * (1 + GRAPH_EXTRA_EDGES));
+    size_t bytesBefore = g_bytesLive, allocsBefore = g_allocCount;
+    {
+        graph_core::GraphBackend graph;
+        mt19937 rng(777);
+        uniform_int_distribution<int> pick(0, n - 1);
+        uniform_int_distribution<int> weight(1, 100);
+
+        for (int i = 0; i < n; i++) {
+            int u = keys[i];
+            int v = keys[(i + 1) % n];
+            int w = weight(rng);
+            ins.samplesNs.push_back(timeNs([&] { graph.addEdge(u, v, w); }));
+            for (int e = 0; e < GRAPH_EXTRA_EDGES; e++) {
+                int x = keys[pick(rng)];
+                int wx = weight(rng);
+                ins.samplesNs.push_back(timeNs([&] { graph.addEdge(u, x, wx); }));
+            }
+        }
+
+        recordFootprint("graph", dist, n, bytesBefore, allocsBefore);
+        benchSnapshot("graph", dist, n, graph);
+
+        int start = keys[0];
+        Result& bfs = newResult("graph", "bfs", dist, n, GRAPH_TRAVERSAL_REPS);
+        Result& dfs = newResult("graph", "dfs", dist, n, GRAPH_TRAVERSAL_REPS);
+        Result& dij = newResult("graph", "dijkstra", dist, n, GRAPH_TRAVERSAL_REPS);
+        Result& prim = newResult("graph", "prim", dist, n, GRAPH_TRAVERSAL_REPS);
+        Result& page = newResult("graph", "dijkstra_page_after_init", dist, n, GRAPH_TRAVERSAL_REPS);
+        for (int r = 0; r < GRAPH_TRAVERSAL_REPS; r++) {
+            bfs.samplesNs.push_back(timeNs([&] { graph.runBFS(start); }));
+            dfs.samplesNs.push_back(timeNs([&] { graph.runDFS(start); }));
+            dij.samplesNs.push_back(timeNs([&] { graph.runDijkstra(start); }));
+            prim.samplesNs.push_back(timeNs([&] { graph.runPrim(start); }));
+            // Skip the n "INF" steps plus the start's update_dist/push so the
+            // timed page comes from the main loop.
+            graph.startTrace("dijkstra", start);
+            graph.skipTo(n + 2);
+            page.samplesNs.push_back(timeNs([&] { graph.nextSteps(TRACE_PAGE); }));
+        }
+
+        // removeVertex scans every adjacency list, so only a bounded sample.
+        int removals = min(n, GRAPH_MAX_REMOVALS);
+        Result& del = newResult("graph", "remove_vertex", dist, n, removals);
+        for (int i = 0; i < removals; i++) {
+            int id = keys[n - 1 - i];
+            del.samplesNs.push_back(timeNs([&] { graph.removeVertex(id); }));
+        }
+    }
+}
+
+// ---- reporting -----------------------------------------------------------
+
+static double percentile(const vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t idx = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[idx];
+}
+
+static void printJson(const vector<int>& sizes) {
+    printf("{\n  \"schema\": 1,\n  \"sizes\": [");
+    for (size_t i = 0; i < sizes.size(); i++) printf("%s%d", i ? ", " : "", sizes[i]);
+    printf("],\n  \"results\": [\n");
+    for (size_t i = 0; i < g_results.size(); i++) {
+        const Result& r = g_results[i];
+        vector<double> s = r.samplesNs;
+        sort(s.begin(), s.end());
+        double total = 0;
+        for (double v : s) total += v;
+        double opsPerSec = total > 0 ? s.size() * 1e9 / total : 0;
+        printf("    {\"backend\": \"%s\", \"op\": \"%s\", \"dist\": \"%s\", \"n\": %d, "
+               "\"ops\": %zu, \"total_ms\": %.3f, \"ops_per_sec\": %.1f, "
+               "\"p50_ns\": %.0f, \"p90_ns\": %.0f, \"p99_ns\": %.0f, \"max_ns\": %.0f}%s\n",
+               r.backend.c_str(), r.op.c_str(), r.dist.c_str(), r.n,
+               s.size(), total / 1e6, opsPerSec,
+               percentile(s, 0.50), percentile(s, 0.90), percentile(s, 0.99),
+               s.empty() ? 0.0 : s.back(),
+               i + 1 < g_results.size() ? "," : "");
+    }
+    printf("  ],\n  \"memory\": [\n");
+    for (size_t i = 0; i < g_footprints.size(); i++) {
+        const Footprint& f = g_footprints[i];
+        printf("    {\"backend\": \"%s\", \"dist\": \"%s\", \"n\": %d, "
+               "\"bytes_live\": %zu, \"allocations\": %zu, \"bytes_per_key\": %.1f}%s\n",
+               f.backend.c_str(), f.dist.c_str(), f.n, f.bytesLive, f.allocations,
+               f.n > 0 ? (double)f.bytesLive / f.n : 0.0,
+               i + 1 < g_footprints.size() ? "," : "");
+    }
+    printf("  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+    vector<int> sizes;
+    for (int i = 1; i < argc; i++) {
+        int n = atoi(argv[i]);
+        if (n <= 0) {
+            fprintf(stderr, "usage: %s [size ...]\n", argv[0]);
+            return 1;
+        }
+        sizes.push_back(n);
+    }
+    if (sizes.empty()) sizes = {1000, 10000};
+
+    for (int n : sizes) {
+        for (const char* dist : DISTRIBUTIONS) {
+            fprintf(stderr, "n=%d dist=%s\n", n, dist);
+            vector<int> keys = makeKeys(dist, n);
+            benchAVL(dist, keys);
+            benchHeap(dist, keys);
+            benchHash(dist, keys);
+            benchGraph(dist, keys);
+        }
+    }
+
+    printJson(sizes);
+    return 0;
+}
@@ -1,215 +1,17 @@
 #include <emscripten/bind.h>
-#include <vector>
-#include <map>
-#include <queue>
-#include <stack>
-#include <string>
-#include <iostream>
+#include "graph_core.h"
 
 using namespace emscripten;
-using namespace std;
+using namespace graph_core;
 
-struct LogStep {
-    string action; // "visit", "push", "pop", "update_dist", "highlight_edge"
-    int nodeA;
-    int nodeB; 
-    string info;
-};
+val saveSnapshot(GraphBackend& backend) {
+    vector<uint8_t> bytes = backend.saveSnapshot();
+    return val::global("Uint8Array").new_(typed_memory_view(bytes.size(), bytes.data()));
+}
 
-class GraphBackend {
-private:
-    map<int, vector<pair<int, int>>> adjList;
-
-public:
-    GraphBackend() {}
-
-    void addVertex(int id) {
-        if (adjList.find(id) == adjList.end()) {
-            adjList[id] = vector<pair<int, int>>();
-        }
-    }
-
-    void addEdge(int u, int v, int weight) {
-        addVertex(u);
-        addVertex(v);
-        adjList[u].push_back(make_pair(v, weight));
-        adjList[v].push_back(make_pair(u, weight));
-    }
-
-    void removeVertex(int id) {
-        adjList.erase(id);
-        for (auto& pair : adjList) {
-            vector<std::pair<int, int>>& neighbors = pair.second;
-            for (int i = 0; i < neighbors.size(); i++) {
-                if (neighbors[i].first == id) {
-                    neighbors[i] = neighbors.back();
-                    neighbors.pop_back();
-                    i--; 
-                }
-            }
-        }
-    }
-
-    vector<LogStep> runBFS(int startNode) {
-        vector<LogStep> logs;
-        if (adjList.find(startNode) == adjList.end()) return logs;
-
-        map<int, bool> visited;
-        queue<int> q;
-
-        visited[startNode] = true;
-        q.push(startNode);
-        logs.push_back({"push", startNode, -1, "Start"});
-
-        while (!q.empty()) {
-            int curr = q.front();
-            q.pop();
-            logs.push_back({"pop", curr, -1, ""});
-            logs.push_back({"visit", curr, -1, ""});
-
-            vector<pair<int, int>> neighbors = adjList[curr];
-            for (int i = 0; i < neighbors.size(); i++) {
-                int neighbor = neighbors[i].first;
-                if (!visited[neighbor]) {
-                    visited[neighbor] = true;
-                    q.push(neighbor);
-                    logs.push_back({"push", neighbor, -1, ""});
-                    logs.push_back({"highlight_edge", curr, neighbor, ""});
-                }
-            }
-        }
-        return logs;
-    }
-
-    vector<LogStep> runDFS(int startNode) {
-        vector<LogStep> logs;
-        if (adjList.find(startNode) == adjList.end()) return logs;
-
-        map<int, bool> visited;
-        stack<int> s;
-
-        s.push(startNode);
-        logs.push_back({"push", startNode, -1, "Start"});
-
-        while (!s.empty()) {
-            int curr = s.top();
-            s.pop();
-            logs.push_back({"pop", curr, -1, ""});
-
-            if (!visited[curr]) {
-                visited[curr] = true;
-                logs.push_back({"visit", curr, -1, ""});
-
-                vector<pair<int, int>> neighbors = adjList[curr];
-                for (int i = neighbors.size() - 1; i >= 0; i--) {
-                    int neighbor = neighbors[i].first;
-                    if (!visited[neighbor]) {
-                        s.push(neighbor);
-                        logs.push_back({"push", neighbor, -1, ""});
-                        logs.push_back({"highlight_edge", curr, neighbor, ""});
-                    }
-                }
-            }
-        }
-        return logs;
-    }
-
-
-    vector<LogStep> runDijkstra(int startNode) {
-        vector<LogStep> logs;
-        map<int, int> dist;
-        map<int, int> parent;
-        
-        for (auto const& [node, neighbors] : adjList) {
-            dist[node] = 999999; 
-            logs.push_back({"update_dist", node, -1, "INF"});
-        }
-        dist[startNode] = 0;
-        logs.push_back({"update_dist", startNode, -1, "0"});
-
-        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
-        pq.push({0, startNode});
-        logs.push_back({"push", startNode, -1, "d:0"});
-
-        while (!pq.empty()) {
-            int u = pq.top().second;
-            int d = pq.top().first;
-            pq.pop();
-            logs.push_back({"pop", u, -1, ""});
-
-            if (d > dist[u]) continue;
-
-            logs.push_back({"visit", u, -1, ""});
-
-            for (auto& edge : adjList[u]) {
-                int v = edge.first;
-                int weight = edge.second;
-
-                if (dist[u] + weight < dist[v]) {
-                    if (parent.count(v)) {
-                        logs.push_back({"unhighlight_edge", parent[v], v, ""});
-                    }
-                    dist[v] = dist[u] + weight;
-                    parent[v] = u;
-                    pq.push({dist[v], v});
-                    logs.push_back({"update_dist", v, -1, to_string(dist[v])});
-                    logs.push_back({"push", v, -1, "d:" + to_string(dist[v])});
-                    logs.push_back({"highlight_edge", u, v, ""}); 
-                }
-            }
-        }
-        return logs;
-    }
-
-    vector<LogStep> runPrim(int startNode) {
-        vector<LogStep> logs;
-        map<int, bool> inMST;
-        map<int, int> key;
-        map<int, int> parent;
-
-        for (auto const& [node, neighbors] : adjList) {
-            key[node] = 999999;
-            inMST[node] = false;
-            logs.push_back({"update_dist", node, -1, "Key: INF"});
-        }
-
-        key[startNode] = 0;
-        logs.push_back({"update_dist", startNode, -1, "Key: 0"});
-        
-        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
-        pq.push({0, startNode});
-        logs.push_back({"push", startNode, -1, "k:0"});
-
-        while(!pq.empty()) {
-            int u = pq.top().second;
-            pq.pop();
-            logs.push_back({"pop", u, -1, ""});
-
-            if(inMST[u]) continue;
-            inMST[u] = true;
-            logs.push_back({"visit", u, -1, ""});
-
-            if(parent.count(u)) {
-                logs.push_back({"highlight_edge", parent[u], u, "MST"});
-            }
-
-            for (auto& edge : adjList[u]) {
-                int v = edge.first;
-                int weight = edge.second;
-
-                if (!inMST[v] && weight < key[v]) {
-                    key[v] = weight;
-                    parent[v] = u;
-                    pq.push({key[v], v});
-                    
-                    logs.push_back({"update_dist", v, -1, "Key: " + to_string(key[v])});
-                    logs.push_back({"push", v, -1, "k:" + to_string(key[v])});
-                }
-            }
-        }
-        return logs;
-    }
-};
+bool loadSnapshot(GraphBackend& backend, const string& buffer) {
+    return backend.loadSnapshot(reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size());
+}
 
 EMSCRIPTEN_BINDINGS(my_module) {
     value_object<LogStep>("LogStep")
@@ -218,6 +20,19 @@ EMSCRIPTEN_BINDINGS(my_module) {
         .field("nodeB", &LogStep::nodeB)
         .field("info", &LogStep::info);
 
+    value_object<perf::CallTiming>("CallTiming")
+        .field("calls", &perf::CallTiming::calls)
+        .field("totalNs", &perf::CallTiming::totalNs)
+        .field("maxNs", &perf::CallTiming::maxNs);
+
+    value_object<Stats>("Stats")
+        .field("comparisons", &Stats::comparisons)
+        .field("edgesRelaxed", &Stats::edgesRelaxed)
+        .field("queuePushes", &Stats::queuePushes)
+        .field("allocations", &Stats::allocations)
+        .field("bytesLive", &Stats::bytesLive)
+        .field("timing", &Stats::timing);
+
     register_vector<LogStep>("VectorLogStep");
 
     class_<GraphBackend>("GraphBackend")
@@ -228,5 +43,15 @@ EMSCRIPTEN_BINDINGS(my_module) {
         .function("runBFS", &GraphBackend::runBFS)
         .function("runDFS", &GraphBackend::runDFS)
         .function("runDijkstra", &GraphBackend::runDijkstra)
-        .function("runPrim", &GraphBackend::runPrim);
+        .function("runPrim", &GraphBackend::runPrim)
+        .function("startTrace", &GraphBackend::startTrace)
+        .function("nextSteps", &GraphBackend::nextSteps)
+        .function("skipTo", &GraphBackend::skipTo)
+        .function("traceDone", &GraphBackend::traceDone)
+        .function("tracePosition", &GraphBackend::tracePosition)
+        .function("getStats", &GraphBackend::getStats)
+        .function("resetStats", &GraphBackend::resetStats)
+        .function("setTiming", &GraphBackend::setTiming)
+        .function("saveSnapshot", &saveSnapshot)
+        .function("loadSnapshot", &loadSnapshot);
 }
\ No newline at end of file
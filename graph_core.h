@@ -0,0 +1,581 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <deque>
+#include <unordered_map>
+#include <queue>
+#include <stack>
+#include <string>
+#include <iostream>
+
+#include "perf_stats.h"
+#include "snapshot.h"
+
+namespace graph_core {
+
+using namespace std;
+
+struct LogStep {
+    string action; // "visit", "push", "pop", "update_dist", "highlight_edge"
+    int nodeA;
+    int nodeB; 
+    string info;
+};
+
+struct Stats {
+    double comparisons;  // distance/key comparisons in Dijkstra and Prim
+    double edgesRelaxed; // adjacency entries examined by any traversal
+    double queuePushes;  // queue, stack and priority queue pushes
+    double allocations;  // new vertices plus adjacency list growth
+    double bytesLive;    // approximate: map nodes plus adjacency capacity
+    perf::CallTiming timing;
+};
+
+// Read-only compressed-sparse-row view over a graph snapshot, usable straight
+// from an mmap'd file. Vertex ids are sorted; targets are indices into ids.
+struct CsrView {
+    int32_t vertexCount;
+    int32_t entryCount; // directed adjacency entries (two per undirected edge)
+    const int32_t* ids;
+    const int32_t* offsets; // vertexCount + 1 entries
+    const int32_t* targets;
+    const int32_t* weights;
+
+    int32_t indexOf(int id) const {
+        const int32_t* it = lower_bound(ids, ids + vertexCount, id);
+        return (it != ids + vertexCount && *it == id) ? (int32_t)(it - ids) : -1;
+    }
+};
+
+inline bool openCsr(const uint8_t* data, size_t len, CsrView& out) {
+    const snapshot::Header* h = snapshot::validate(data, len, snapshot::GRAPH_CSR);
+    if (h == nullptr || snapshot::payloadInts(h) < 3) return false;
+    const int32_t* p = snapshot::payload(h);
+    int32_t V = p[0], E = p[1];
+    if (V < 0 || E < 0) return false;
+    // 64-bit arithmetic: size_t is 32 bits on wasm and V/E come from the buffer.
+    if (snapshot::payloadInts(h) != 2 + (uint64_t)V + ((uint64_t)V + 1) + 2 * (uint64_t)E) return false;
+
+    CsrView v;
+    v.vertexCount = V;
+    v.entryCount = E;
+    v.ids = p + 2;
+    v.offsets = v.ids + V;
+    v.targets = v.offsets + V + 1;
+    v.weights = v.targets + E;
+
+    for (int32_t i = 1; i < V; i++) {
+        if (v.ids[i] <= v.ids[i - 1]) return false;
+    }
+    if (v.offsets[0] != 0 || v.offsets[V] != E) return false;
+    for (int32_t i = 0; i < V; i++) {
+        if (v.offsets[i + 1] < v.offsets[i]) return false;
+    }
+    for (int32_t e = 0; e < E; e++) {
+        if (v.targets[e] < 0 || v.targets[e] >= V) return false;
+    }
+
+    // addEdge() always stores an edge in both directions with one weight (a
+    // self-loop as two identical entries). Keyed by (min, max) endpoint, the
+    // entries stored from the smaller endpoint must match those stored from
+    // the larger one, and every self-loop entry must come in a pair.
+    typedef pair<uint64_t, int32_t> EdgeKey; // (lo << 32 | hi, weight)
+    vector<EdgeKey> fromLow, fromHigh, loops;
+    fromLow.reserve(E / 2);
+    fromHigh.reserve(E / 2);
+    for (int32_t i = 0; i < V; i++) {
+        for (int32_t e = v.offsets[i]; e < v.offsets[i + 1]; e++) {
+            int32_t t = v.targets[e];
+            int32_t lo = min(i, t), hi = max(i, t);
+            EdgeKey key((uint64_t)lo << 32 | (uint32_t)hi, v.weights[e]);
+            if (i < t) fromLow.push_back(key);
+            else if (i > t) fromHigh.push_back(key);
+            else loops.push_back(key);
+        }
+    }
+    sort(fromLow.begin(), fromLow.end());
+    sort(fromHigh.begin(), fromHigh.end());
+    if (fromLow != fromHigh) return false;
+    sort(loops.begin(), loops.end());
+    for (size_t e = 0; e < loops.size(); e += 2) {
+        if (e + 1 == loops.size() || loops[e] != loops[e + 1]) return false;
+    }
+    out = v;
+    return true;
+}
+
+class GraphBackend {
+private:
+    map<int, vector<pair<int, int>>> adjList;
+    Stats stats;
+    bool timingEnabled;
+
+    void ensureVertex(int id) {
+        if (adjList.find(id) == adjList.end()) {
+            adjList[id] = vector<pair<int, int>>();
+            stats.allocations++;
+        }
+    }
+
+    void appendNeighbor(int u, int v, int weight) {
+        vector<pair<int, int>>& neighbors = adjList[u];
+        if (neighbors.size() == neighbors.capacity()) stats.allocations++;
+        neighbors.push_back(make_pair(v, weight));
+    }
+
+    // ---- resumable traces ----------------------------------------------
+    // Each algorithm runs as an explicit state machine: advance() performs
+    // one unit of work (one init entry, one pop, or one neighbour) and queues
+    // the steps it produces. Memory is the algorithm state plus the handful
+    // of steps a single unit can emit. That state is O(V) for BFS, but
+    // O(V + E) in the worst case for the DFS stack and the lazy-deletion
+    // priority queue in Dijkstra/Prim, which keep stale entries.
+
+    enum TraceAlgorithm { TRACE_NONE, TRACE_BFS, TRACE_DFS, TRACE_DIJKSTRA, TRACE_PRIM };
+
+    static constexpr int TRACE_PAGE_RESERVE = 1024;
+    static constexpr int INF = 999999;
+
+    struct TraceState {
+        TraceAlgorithm algo = TRACE_NONE;
+        int startNode = -1;
+        int position = 0; // steps handed out so far
+        bool finished = true;
+        deque<LogStep> pending;
+
+        // Dijkstra/Prim emit an "INF" step per vertex before the main loop.
+        bool initializing = false;
+        map<int, vector<pair<int, int>>>::const_iterator initIt;
+
+        set<int> visited;       // BFS/DFS visited set, Prim's inMST
+        map<int, int> dist;     // Dijkstra distance, Prim key; absent means INF
+        map<int, int> parent;
+        queue<int> q;
+        stack<int> s;
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+
+        // Vertex whose neighbours are being scanned, if any.
+        int current = -1;
+        const vector<pair<int, int>>* neighbors = nullptr;
+        int nextNeighbor = 0;
+    };
+
+    TraceState trace;
+
+    static TraceAlgorithm parseAlgorithm(const string& name) {
+        if (name == "bfs") return TRACE_BFS;
+        if (name == "dfs") return TRACE_DFS;
+        if (name == "dijkstra") return TRACE_DIJKSTRA;
+        if (name == "prim") return TRACE_PRIM;
+        return TRACE_NONE;
+    }
+
+    static int distOf(const TraceState& t, int v) {
+        auto it = t.dist.find(v);
+        return it == t.dist.end() ? INF : it->second;
+    }
+
+    // Called on every graph edit, so it must stay free when no trace runs.
+    void cancelTrace() {
+        if (trace.algo != TRACE_NONE) trace = TraceState();
+    }
+
+    const vector<pair<int, int>>* neighborsOf(int id) const {
+        auto it = adjList.find(id);
+        return it == adjList.end() ? nullptr : &it->second;
+    }
+
+    void beginTrace(TraceState& t, TraceAlgorithm algo, int startNode) {
+        t = TraceState();
+        t.algo = algo;
+        t.startNode = startNode;
+        t.finished = false;
+
+        if (algo == TRACE_BFS || algo == TRACE_DFS) {
+            if (adjList.find(startNode) == adjList.end()) {
+                t.finished = true;
+                return;
+            }
+            if (algo == TRACE_BFS) {
+                t.visited.insert(startNode);
+                t.q.push(startNode);
+            } else {
+                t.s.push(startNode);
+            }
+            stats.queuePushes++;
+            t.pending.push_back({"push", startNode, -1, "Start"});
+            return;
+        }
+
+        // Vertices without a dist entry count as INF, so nothing is
+        // initialized up front and the first page stays cheap.
+        t.initializing = true;
+        t.initIt = adjList.begin();
+    }
+
+    // Makes sure a step is queued in t.pending. Returns false once the
+    // trace has nothing left to give.
+    bool fillPending(TraceState& t) {
+        while (t.pending.empty()) {
+            if (t.finished || !advance(t)) {
+                t.finished = true;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Like fillPending(), but counts the front step as handed out; the
+    // caller pops it.
+    bool takeStep(TraceState& t) {
+        if (!fillPending(t)) return false;
+        t.position++;
+        return true;
+    }
+
+    bool advance(TraceState& t) {
+        if (t.initializing) {
+            advanceInit(t);
+            return true;
+        }
+        if (t.neighbors != nullptr && scanNeighbor(t)) return true;
+        t.neighbors = nullptr;
+
+        switch (t.algo) {
+            case TRACE_BFS: return popBFS(t);
+            case TRACE_DFS: return popDFS(t);
+            case TRACE_DIJKSTRA: return popDijkstra(t);
+            case TRACE_PRIM: return popPrim(t);
+            default: return false;
+        }
+    }
+
+    void advanceInit(TraceState& t) {
+        bool prim = t.algo == TRACE_PRIM;
+        if (t.initIt != adjList.end()) {
+            t.pending.push_back({"update_dist", t.initIt->first, -1, prim ? "Key: INF" : "INF"});
+            ++t.initIt;
+            return;
+        }
+        t.initializing = false;
+        t.dist[t.startNode] = 0;
+        t.pending.push_back({"update_dist", t.startNode, -1, prim ? "Key: 0" : "0"});
+        t.pq.push({0, t.startNode});
+        stats.queuePushes++;
+        t.pending.push_back({"push", t.startNode, -1, prim ? "k:0" : "d:0"});
+    }
+
+    void startScan(TraceState& t, int u) {
+        t.current = u;
+        t.neighbors = neighborsOf(u);
+        // DFS pushes neighbours in reverse so they pop in adjacency order.
+        if (t.algo == TRACE_DFS && t.neighbors != nullptr) t.nextNeighbor = (int)t.neighbors->size() - 1;
+        else t.nextNeighbor = 0;
+    }
+
+    bool popBFS(TraceState& t) {
+        if (t.q.empty()) return false;
+        int curr = t.q.front();
+        t.q.pop();
+        t.pending.push_back({"pop", curr, -1, ""});
+        t.pending.push_back({"visit", curr, -1, ""});
+        startScan(t, curr);
+        return true;
+    }
+
+    bool popDFS(TraceState& t) {
+        if (t.s.empty()) return false;
+        int curr = t.s.top();
+        t.s.pop();
+        t.pending.push_back({"pop", curr, -1, ""});
+        if (!t.visited.count(curr)) {
+            t.visited.insert(curr);
+            t.pending.push_back({"visit", curr, -1, ""});
+            startScan(t, curr);
+        }
+        return true;
+    }
+
+    bool popDijkstra(TraceState& t) {
+        if (t.pq.empty()) return false;
+        int u = t.pq.top().second;
+        int d = t.pq.top().first;
+        t.pq.pop();
+        t.pending.push_back({"pop", u, -1, ""});
+
+        stats.comparisons++;
+        if (d > distOf(t, u)) return true;
+
+        t.pending.push_back({"visit", u, -1, ""});
+        startScan(t, u);
+        return true;
+    }
+
+    bool popPrim(TraceState& t) {
+        if (t.pq.empty()) return false;
+        int u = t.pq.top().second;
+        t.pq.pop();
+        t.pending.push_back({"pop", u, -1, ""});
+
+        if (t.visited.count(u)) return true;
+        t.visited.insert(u);
+        t.pending.push_back({"visit", u, -1, ""});
+
+        if (t.parent.count(u)) {
+            t.pending.push_back({"highlight_edge", t.parent[u], u, "MST"});
+        }
+        startScan(t, u);
+        return true;
+    }
+
+    // Examines the next neighbour of t.current. Returns false when the
+    // adjacency list is exhausted.
+    bool scanNeighbor(TraceState& t) {
+        const vector<pair<int, int>>& neighbors = *t.neighbors;
+        if (t.nextNeighbor < 0 || t.nextNeighbor >= (int)neighbors.size()) return false;
+        int u = t.current;
+        int v = neighbors[t.nextNeighbor].first;
+        int weight = neighbors[t.nextNeighbor].second;
+        t.nextNeighbor += t.algo == TRACE_DFS ? -1 : 1;
+        stats.edgesRelaxed++;
+
+        switch (t.algo) {
+            case TRACE_BFS:
+                if (!t.visited.count(v)) {
+                    t.visited.insert(v);
+                    t.q.push(v);
+                    stats.queuePushes++;
+                    t.pending.push_back({"push", v, -1, ""});
+                    t.pending.push_back({"highlight_edge", u, v, ""});
+                }
+                break;
+
+            case TRACE_DFS:
+                if (!t.visited.count(v)) {
+                    t.s.push(v);
+                    stats.queuePushes++;
+                    t.pending.push_back({"push", v, -1, ""});
+                    t.pending.push_back({"highlight_edge", u, v, ""});
+                }
+                break;
+
+            case TRACE_DIJKSTRA:
+                stats.comparisons++;
+                if (distOf(t, u) + weight < distOf(t, v)) {
+                    if (t.parent.count(v)) {
+                        t.pending.push_back({"unhighlight_edge", t.parent[v], v, ""});
+                    }
+                    t.dist[v] = t.dist[u] + weight;
+                    t.parent[v] = u;
+                    t.pq.push({t.dist[v], v});
+                    stats.queuePushes++;
+                    t.pending.push_back({"update_dist", v, -1, to_string(t.dist[v])});
+                    t.pending.push_back({"push", v, -1, "d:" + to_string(t.dist[v])});
+                    t.pending.push_back({"highlight_edge", u, v, ""});
+                }
+                break;
+
+            case TRACE_PRIM:
+                stats.comparisons++;
+                if (!t.visited.count(v) && weight < distOf(t, v)) {
+                    t.dist[v] = weight;
+                    t.parent[v] = u;
+                    t.pq.push({t.dist[v], v});
+                    stats.queuePushes++;
+                    t.pending.push_back({"update_dist", v, -1, "Key: " + to_string(t.dist[v])});
+                    t.pending.push_back({"push", v, -1, "k:" + to_string(t.dist[v])});
+                }
+                break;
+
+            default:
+                break;
+        }
+        return true;
+    }
+
+    // Materializes a whole trace in one go, for the run* entry points.
+    vector<LogStep> runTrace(TraceAlgorithm algo, int startNode) {
+        perf::ScopedCallTimer timer(stats.timing, timingEnabled);
+        vector<LogStep> logs;
+        TraceState t;
+        beginTrace(t, algo, startNode);
+        while (takeStep(t)) {
+            logs.push_back(std::move(t.pending.front()));
+            t.pending.pop_front();
+        }
+        return logs;
+    }
+
+public:
+    GraphBackend() : stats(), timingEnabled(false) {}
+
+    void addVertex(int id) {
+        perf::ScopedCallTimer timer(stats.timing, timingEnabled);
+        cancelTrace();
+        ensureVertex(id);
+    }
+
+    void addEdge(int u, int v, int weight) {
+        perf::ScopedCallTimer timer(stats.timing, timingEnabled);
+        cancelTrace();
+        ensureVertex(u);
+        ensureVertex(v);
+        appendNeighbor(u, v, weight);
+        appendNeighbor(v, u, weight);
+    }
+
+    void removeVertex(int id) {
+        perf::ScopedCallTimer timer(stats.timing, timingEnabled);
+        cancelTrace();
+        adjList.erase(id);
+        for (auto& pair : adjList) {
+            vector<std::pair<int, int>>& neighbors = pair.second;
+            for (int i = 0; i < neighbors.size(); i++) {
+                if (neighbors[i].first == id) {
+                    neighbors[i] = neighbors.back();
+                    neighbors.pop_back();
+                    i--; 
+                }
+            }
+        }
+    }
+
+    vector<LogStep> runBFS(int startNode) {
+        return runTrace(TRACE_BFS, startNode);
+    }
+
+    vector<LogStep> runDFS(int startNode) {
+        return runTrace(TRACE_DFS, startNode);
+    }
+
+    vector<LogStep> runDijkstra(int startNode) {
+        return runTrace(TRACE_DIJKSTRA, startNode);
+    }
+
+    vector<LogStep> runPrim(int startNode) {
+        return runTrace(TRACE_PRIM, startNode);
+    }
+
+    // Lazy counterpart of the run* calls: startTrace() sets up the algorithm
+    // and nextSteps()/skipTo() generate the same steps on demand. Any change
+    // to the graph ends the trace. Returns false for an unknown algorithm.
+    bool startTrace(string algorithm, int startNode) {
+        perf::ScopedCallTimer timer(stats.timing, timingEnabled);
+        TraceAlgorithm algo = parseAlgorithm(algorithm);
+        if (algo == TRACE_NONE) {
+            cancelTrace();
+            return false;
+        }
+        beginTrace(trace, algo, startNode);
+        return true;
+    }
+
+    vector<LogStep> nextSteps(int maxCount) {
+        perf::ScopedCallTimer timer(stats.timing, timingEnabled);
+        vector<LogStep> page;
+        if (maxCount > 0) page.reserve(min(maxCount, TRACE_PAGE_RESERVE));
+        while ((int)page.size() < maxCount && takeStep(trace)) {
+            page.push_back(std::move(trace.pending.front()));
+            trace.pending.pop_front();
+        }
+        return page;
+    }
+
+    // Moves the trace so the next step handed out is `step`, restarting it
+    // if that lies behind. Returns the new position, which falls short of
+    // `step` only if the trace ends first.
+    int skipTo(int step) {
+        perf::ScopedCallTimer timer(stats.timing, timingEnabled);
+        if (trace.algo == TRACE_NONE) return 0;
+        if (step < trace.position) beginTrace(trace, trace.algo, trace.startNode);
+        while (trace.position < step && takeStep(trace)) trace.pending.pop_front();
+        return trace.position;
+    }
+
+    bool traceDone() {
+        return !fillPending(trace);
+    }
+
+    int tracePosition() {
+        return trace.position;
+    }
+
+    vector<uint8_t> saveSnapshot() {
+        vector<int32_t> ids;
+        unordered_map<int, int32_t> indexOf;
+        ids.reserve(adjList.size());
+        indexOf.reserve(adjList.size());
+        size_t entries = 0;
+        for (auto const& [node, neighbors] : adjList) {
+            indexOf[node] = ids.size();
+            ids.push_back(node);
+            entries += neighbors.size();
+        }
+
+        snapshot::Writer w;
+        w.reserve(2 + ids.size() * 2 + 1 + entries * 2);
+        w.put((int32_t)ids.size());
+        w.put((int32_t)entries);
+        for (int32_t id : ids) w.put(id);
+        int32_t offset = 0;
+        w.put(offset);
+        for (auto const& [node, neighbors] : adjList) {
+            offset += neighbors.size();
+            w.put(offset);
+        }
+        for (auto const& [node, neighbors] : adjList) {
+            for (auto const& edge : neighbors) w.put(indexOf[edge.first]);
+        }
+        for (auto const& [node, neighbors] : adjList) {
+            for (auto const& edge : neighbors) w.put(edge.second);
+        }
+        return w.finish(snapshot::GRAPH_CSR, 0);
+    }
+
+    // Replaces the graph with the snapshot's, keeping adjacency order so
+    // traversals replay identically. Leaves the graph untouched and returns
+    // false if the buffer is not a valid graph snapshot.
+    bool loadSnapshot(const uint8_t* data, size_t len) {
+        CsrView view;
+        if (!openCsr(data, len, view)) return false;
+
+        map<int, vector<pair<int, int>>> loaded;
+        for (int32_t i = 0; i < view.vertexCount; i++) {
+            vector<pair<int, int>>& neighbors = loaded.emplace_hint(loaded.end(), view.ids[i], vector<pair<int, int>>())->second;
+            neighbors.reserve(view.offsets[i + 1] - view.offsets[i]);
+            for (int32_t e = view.offsets[i]; e < view.offsets[i + 1]; e++) {
+                neighbors.push_back(make_pair(view.ids[view.targets[e]], view.weights[e]));
+            }
+            stats.allocations += neighbors.empty() ? 1 : 2;
+        }
+
+        cancelTrace();
+        adjList.swap(loaded);
+        return true;
+    }
+
+    Stats getStats() {
+        Stats s = stats;
+        // Red-black tree nodes carry three pointers and a colour on top of the value.
+        const double mapNodeBytes = sizeof(pair<const int, vector<pair<int, int>>>) + 4 * sizeof(void*);
+        s.bytesLive = 0;
+        for (auto const& [node, neighbors] : adjList) {
+            s.bytesLive += mapNodeBytes + (double)neighbors.capacity() * sizeof(pair<int, int>);
+        }
+        return s;
+    }
+
+    void resetStats() {
+        stats = Stats();
+    }
+
+    void setTiming(bool enabled) {
+        timingEnabled = enabled;
+    }
+};
+
+} // namespace graph_core
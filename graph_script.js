@@ -1,5 +1,6 @@
 let cppGraph = null;
 let isAnimating = false;
+const TRACE_PAGE = 64; // steps fetched from the backend at a time
 
 let nodes = []; // {id, x, y}
 let edges = []; // {u, v, weight}
@@ -33,13 +34,16 @@ function addEdgeLogic(u, v, w) {
     renderGraph();
 }
 
+// Graph edits end the backend's trace, so they wait for the animation.
 function handleAddNode() {
+    if(isAnimating) return;
     const id = document.getElementById('nodeInput').value;
     if(!id) return;
     addNodeLogic(id, 400 + (Math.random()*50), 300 + (Math.random()*50));
 }
 
 function handleRemoveNode() {
+    if(isAnimating) return;
     const id = parseInt(document.getElementById('nodeInput').value);
     nodes = nodes.filter(n => n.id !== id);
     edges = edges.filter(e => e.u !== id && e.v !== id);
@@ -48,6 +52,7 @@ function handleRemoveNode() {
 }
 
 function handleAddEdge() {
+    if(isAnimating) return;
     const u = document.getElementById('uInput').value;
     const v = document.getElementById('vInput').value;
     const w = document.getElementById('wInput').value;
@@ -177,28 +182,52 @@ function runAlgorithm() {
     
     if(!nodes.find(n => n.id === start)) { alert("Invalid Start Node"); return; }
 
-    let logs;
-    if(algo === 'bfs') logs = cppGraph.runBFS(start);
-    if(algo === 'dfs') logs = cppGraph.runDFS(start);
-    if(algo === 'dijkstra') logs = cppGraph.runDijkstra(start);
-    if(algo === 'prim') logs = cppGraph.runPrim(start);
+    animate(traceReader(algo, start));
+}
+
+// Returns a function yielding one step per call (null when finished).
+// Steps are pulled from the backend a page at a time so large graphs never
+// build the whole trace.
+function traceReader(algo, start) {
+    // The committed graph_core.wasm predates startTrace; drop this branch
+    // once it is rebuilt from graph_core.cpp (see README).
+    if(!cppGraph.startTrace) {
+        let logs;
+        if(algo === 'bfs') logs = cppGraph.runBFS(start);
+        if(algo === 'dfs') logs = cppGraph.runDFS(start);
+        if(algo === 'dijkstra') logs = cppGraph.runDijkstra(start);
+        if(algo === 'prim') logs = cppGraph.runPrim(start);
+        let i = 0;
+        return () => i < logs.size() ? logs.get(i++) : null;
+    }
 
-    animate(logs);
+    cppGraph.startTrace(algo, start);
+    let page = [];
+    let i = 0;
+    return () => {
+        if(i >= page.length) {
+            const steps = cppGraph.nextSteps(TRACE_PAGE);
+            page = [];
+            for(let j = 0; j < steps.size(); j++) page.push(steps.get(j));
+            steps.delete();
+            i = 0;
+            if(page.length === 0) return null;
+        }
+        return page[i++];
+    };
 }
 
-function animate(logs) {
+function animate(nextLog) {
     isAnimating = true;
     const dsContainer = document.getElementById('dsContainer');
     dsContainer.innerHTML = '';
     
-    let i = 0;
     function step() {
-        if(i >= logs.size()) {
+        const log = nextLog();
+        if(!log) {
             isAnimating = false;
             return;
         }
-
-        const log = logs.get(i);
         
         if(log.action === 'visit') {
             const nodeEl = document.querySelector(`#node-${log.nodeA} .node-circle`);
@@ -253,7 +282,6 @@ function animate(logs) {
             }
         }
 
-        i++;
         setTimeout(() => requestAnimationFrame(step), 700);
     }
     step();
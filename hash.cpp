@@ -1,123 +1,17 @@
 #include <emscripten/bind.h>
-#include <vector>
-#include <string>
-#include <iostream>
+#include "hash_core.h"
 
 using namespace emscripten;
-using namespace std;
+using namespace hash_core;
 
-struct Node {
-    int key;
-    Node* next;
-    Node(int k) : key(k), next(nullptr) {}
-};
+val saveSnapshot(HashTableBackend& backend) {
+    vector<uint8_t> bytes = backend.saveSnapshot();
+    return val::global("Uint8Array").new_(typed_memory_view(bytes.size(), bytes.data()));
+}
 
-struct LogStep {
-    string action; // "compute_hash", "traverse", "insert", "duplicate", "found", "not_found"
-    int bucketIdx; 
-    int keyVal;    
-    string info;
-};
-
-struct BucketSnapshot {
-    int index;
-    vector<int> keys;
-};
-
-class HashTableBackend {
-private:
-    const int TABLE_SIZE = 10;
-    vector<Node*> table;
-    vector<LogStep> logs;
-
-    int hashFunction(int key) {
-        return key % TABLE_SIZE;
-    }
-
-public:
-    HashTableBackend() {
-        for (int i = 0; i < TABLE_SIZE; i++) table.push_back(nullptr);
-    }
-
-    ~HashTableBackend() {
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            Node* curr = table[i];
-            while (curr) {
-                Node* temp = curr;
-                curr = curr->next;
-                delete temp;
-            }
-        }
-    }
-
-    vector<LogStep> insert(int key) {
-        logs.clear();
-        int index = hashFunction(key);
-        logs.push_back({"compute_hash", index, key, "Hash: " + to_string(key) + " % 10 = " + to_string(index)});
-
-        if (table[index] == nullptr) {
-            table[index] = new Node(key);
-            logs.push_back({"insert", index, key, "Inserted as Head"});
-            return logs;
-        }
-
-        Node* curr = table[index];
-        
-        if (curr->key == key) {
-            logs.push_back({"duplicate", index, key, "Duplicate Key Ignored"});
-            return logs;
-        }
-
-        while (curr->next != nullptr) {
-            logs.push_back({"traverse", index, curr->key, "Traversing " + to_string(curr->key)});
-            if (curr->next->key == key) {
-                logs.push_back({"duplicate", index, key, "Duplicate Key Ignored"});
-                return logs;
-            }
-            curr = curr->next;
-        }
-
-        logs.push_back({"traverse", index, curr->key, "Reached Tail"});
-        curr->next = new Node(key);
-        logs.push_back({"insert", index, key, "Inserted at Tail"});
-        
-        return logs;
-    }
-
-    vector<LogStep> search(int key) {
-        logs.clear();
-        int index = hashFunction(key);
-        logs.push_back({"compute_hash", index, key, "Searching Bucket " + to_string(index)});
-
-        Node* curr = table[index];
-        while (curr != nullptr) {
-            logs.push_back({"traverse", index, curr->key, "Checking " + to_string(curr->key)});
-            if (curr->key == key) {
-                logs.push_back({"found", index, key, "Found Key " + to_string(key)});
-                return logs;
-            }
-            curr = curr->next;
-        }
-
-        logs.push_back({"not_found", index, key, "Key Not Found"});
-        return logs;
-    }
-
-    vector<BucketSnapshot> getSnapshot() {
-        vector<BucketSnapshot> snapshot;
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            BucketSnapshot bs;
-            bs.index = i;
-            Node* curr = table[i];
-            while (curr != nullptr) {
-                bs.keys.push_back(curr->key);
-                curr = curr->next;
-            }
-            snapshot.push_back(bs);
-        }
-        return snapshot;
-    }
-};
+bool loadSnapshot(HashTableBackend& backend, const string& buffer) {
+    return backend.loadSnapshot(reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size());
+}
 
 EMSCRIPTEN_BINDINGS(hash_module) {
     value_object<LogStep>("LogStep")
@@ -130,6 +24,18 @@ EMSCRIPTEN_BINDINGS(hash_module) {
         .field("index", &BucketSnapshot::index)
         .field("keys", &BucketSnapshot::keys);
 
+    value_object<perf::CallTiming>("CallTiming")
+        .field("calls", &perf::CallTiming::calls)
+        .field("totalNs", &perf::CallTiming::totalNs)
+        .field("maxNs", &perf::CallTiming::maxNs);
+
+    value_object<Stats>("Stats")
+        .field("probes", &Stats::probes)
+        .field("maxChainLength", &Stats::maxChainLength)
+        .field("allocations", &Stats::allocations)
+        .field("bytesLive", &Stats::bytesLive)
+        .field("timing", &Stats::timing);
+
     register_vector<LogStep>("VectorLogStep");
     register_vector<int>("VectorInt");
     register_vector<BucketSnapshot>("VectorBucketSnapshot");
@@ -138,5 +44,10 @@ EMSCRIPTEN_BINDINGS(hash_module) {
         .constructor<>()
         .function("insert", &HashTableBackend::insert)
         .function("search", &HashTableBackend::search)
-        .function("getSnapshot", &HashTableBackend::getSnapshot);
+        .function("getSnapshot", &HashTableBackend::getSnapshot)
+        .function("getStats", &HashTableBackend::getStats)
+        .function("resetStats", &HashTableBackend::resetStats)
+        .function("setTiming", &HashTableBackend::setTiming)
+        .function("saveSnapshot", &saveSnapshot)
+        .function("loadSnapshot", &loadSnapshot);
 }
\ No newline at end of file
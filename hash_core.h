@@ -0,0 +1,232 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <string>
+#include <iostream>
+
+#include "perf_stats.h"
+#include "snapshot.h"
+
+namespace hash_core {
+
+using namespace std;
+
+struct Node {
+    int key;
+    Node* next;
+    Node(int k) : key(k), next(nullptr) {}
+};
+
+struct LogStep {
+    string action; // "compute_hash", "traverse", "insert", "duplicate", "found", "not_found"
+    int bucketIdx; 
+    int keyVal;    
+    string info;
+};
+
+struct BucketSnapshot {
+    int index;
+    vector<int> keys;
+};
+
+struct Stats {
+    double probes;         // chain nodes visited, each one key comparison
+    double maxChainLength; // longest bucket right now
+    double allocations;    // nodes allocated since the last reset
+    double bytesLive;      // nodes plus the bucket array
+    perf::CallTiming timing;
+};
+
+class HashTableBackend {
+private:
+    const int TABLE_SIZE = 10;
+    vector<Node*> table;
+    vector<int> chainLength;
+    vector<LogStep> logs;
+    Stats stats;
+    int liveNodes;
+    bool timingEnabled;
+
+    int hashFunction(int key) {
+        return key % TABLE_SIZE;
+    }
+
+    void freeChains() {
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            Node* curr = table[i];
+            while (curr) {
+                Node* temp = curr;
+                curr = curr->next;
+                delete temp;
+            }
+            table[i] = nullptr;
+            chainLength[i] = 0;
+        }
+        liveNodes = 0;
+    }
+
+public:
+    HashTableBackend() : stats(), liveNodes(0), timingEnabled(false) {
+        for (int i = 0; i < TABLE_SIZE; i++) table.push_back(nullptr);
+        chainLength.assign(TABLE_SIZE, 0);
+    }
+
+    ~HashTableBackend() {
+        freeChains();
+    }
+
+    vector<LogStep> insert(int key) {
+        perf::ScopedCallTimer timer(stats.timing, timingEnabled);
+        logs.clear();
+        int index = hashFunction(key);
+        logs.push_back({"compute_hash", index, key, "Hash: " + to_string(key) + " % 10 = " + to_string(index)});
+
+        if (table[index] == nullptr) {
+            table[index] = new Node(key);
+            stats.allocations++;
+            liveNodes++;
+            chainLength[index]++;
+            logs.push_back({"insert", index, key, "Inserted as Head"});
+            return logs;
+        }
+
+        Node* curr = table[index];
+        stats.probes++;
+        
+        if (curr->key == key) {
+            logs.push_back({"duplicate", index, key, "Duplicate Key Ignored"});
+            return logs;
+        }
+
+        while (curr->next != nullptr) {
+            logs.push_back({"traverse", index, curr->key, "Traversing " + to_string(curr->key)});
+            stats.probes++;
+            if (curr->next->key == key) {
+                logs.push_back({"duplicate", index, key, "Duplicate Key Ignored"});
+                return logs;
+            }
+            curr = curr->next;
+        }
+
+        logs.push_back({"traverse", index, curr->key, "Reached Tail"});
+        curr->next = new Node(key);
+        stats.allocations++;
+        liveNodes++;
+        chainLength[index]++;
+        logs.push_back({"insert", index, key, "Inserted at Tail"});
+        
+        return logs;
+    }
+
+    vector<LogStep> search(int key) {
+        perf::ScopedCallTimer timer(stats.timing, timingEnabled);
+        logs.clear();
+        int index = hashFunction(key);
+        logs.push_back({"compute_hash", index, key, "Searching Bucket " + to_string(index)});
+
+        Node* curr = table[index];
+        while (curr != nullptr) {
+            logs.push_back({"traverse", index, curr->key, "Checking " + to_string(curr->key)});
+            stats.probes++;
+            if (curr->key == key) {
+                logs.push_back({"found", index, key, "Found Key " + to_string(key)});
+                return logs;
+            }
+            curr = curr->next;
+        }
+
+        logs.push_back({"not_found", index, key, "Key Not Found"});
+        return logs;
+    }
+
+    vector<BucketSnapshot> getSnapshot() {
+        vector<BucketSnapshot> snapshot;
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            BucketSnapshot bs;
+            bs.index = i;
+            Node* curr = table[i];
+            while (curr != nullptr) {
+                bs.keys.push_back(curr->key);
+                curr = curr->next;
+            }
+            snapshot.push_back(bs);
+        }
+        return snapshot;
+    }
+
+    vector<uint8_t> saveSnapshot() {
+        snapshot::Writer w;
+        w.reserve(1 + (TABLE_SIZE + 1) + liveNodes);
+        w.put(TABLE_SIZE);
+        int32_t offset = 0;
+        w.put(offset);
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            offset += chainLength[i];
+            w.put(offset);
+        }
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            for (Node* curr = table[i]; curr != nullptr; curr = curr->next) w.put(curr->key);
+        }
+        return w.finish(snapshot::HASH_BUCKETS, 0);
+    }
+
+    // Replaces every bucket with the snapshot's, keeping chain order. Leaves
+    // the table untouched and returns false if the buffer is not a valid
+    // snapshot of a table this size.
+    bool loadSnapshot(const uint8_t* data, size_t len) {
+        const snapshot::Header* h = snapshot::validate(data, len, snapshot::HASH_BUCKETS);
+        if (h == nullptr || snapshot::payloadInts(h) < (size_t)TABLE_SIZE + 2) return false;
+        const int32_t* p = snapshot::payload(h);
+        if (p[0] != TABLE_SIZE) return false;
+
+        const int32_t* offsets = p + 1;
+        const int32_t* keys = offsets + TABLE_SIZE + 1;
+        if (offsets[0] != 0) return false;
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            if (offsets[i + 1] < offsets[i]) return false;
+        }
+        int32_t keyCount = offsets[TABLE_SIZE];
+        if (snapshot::payloadInts(h) != (uint64_t)TABLE_SIZE + 2 + keyCount) return false;
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            for (int32_t k = offsets[i]; k < offsets[i + 1]; k++) {
+                if (hashFunction(keys[k]) != i) return false;
+            }
+            // insert() never stores a key twice; don't let a snapshot either.
+            vector<int32_t> chain(keys + offsets[i], keys + offsets[i + 1]);
+            sort(chain.begin(), chain.end());
+            if (adjacent_find(chain.begin(), chain.end()) != chain.end()) return false;
+        }
+
+        freeChains();
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            Node** tail = &table[i];
+            for (int32_t k = offsets[i]; k < offsets[i + 1]; k++) {
+                *tail = new Node(keys[k]);
+                tail = &(*tail)->next;
+            }
+            chainLength[i] = offsets[i + 1] - offsets[i];
+        }
+        liveNodes = keyCount;
+        stats.allocations += keyCount;
+        return true;
+    }
+
+    Stats getStats() {
+        Stats s = stats;
+        s.maxChainLength = *max_element(chainLength.begin(), chainLength.end());
+        s.bytesLive = (double)liveNodes * sizeof(Node) + (double)table.capacity() * sizeof(Node*);
+        return s;
+    }
+
+    void resetStats() {
+        stats = Stats();
+    }
+
+    void setTiming(bool enabled) {
+        timingEnabled = enabled;
+    }
+};
+
+} // namespace hash_core
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <algorithm>
+#include <iostream>
+
+#include "perf_stats.h"
+#include "snapshot.h"
+
+namespace heap_core {
+
+using namespace std;
+
+struct LogStep {
+    string action; 
+    int indexA;
+    int indexB;
+    string info;
+};
+
+struct Stats {
+    double comparisons;
+    double swaps;
+    double allocations; // times the backing array had to grow
+    double bytesLive;   // capacity of the backing array
+    perf::CallTiming timing;
+};
+
+const uint32_t SNAPSHOT_MIN_HEAP = 1; // header flag: heap was in min mode
+
+class HeapBackend {
+private:
+    vector<int> heap;
+    bool isMinHeap;
+    Stats stats;
+    bool timingEnabled;
+
+    int parent(int i) { return (i - 1) / 2; }
+    int left(int i) { return (2 * i) + 1; }
+    int right(int i) { return (2 * i) + 2; }
+
+    bool compare(int a, int b) {
+        stats.comparisons++;
+        if (isMinHeap) return a < b; 
+        else return a > b;
+    }
+
+    void swapNodes(int i, int j) {
+        logs.push_back({"highlight", i, j, "Comparing..."});
+        stats.swaps++;
+        int temp = heap[i];
+        heap[i] = heap[j];
+        heap[j] = temp;
+        logs.push_back({"swap", i, j, "Swapping"});
+    }
+
+    void heapifyUp(int i) {
+        while (i != 0 && compare(heap[i], heap[parent(i)])) {
+            swapNodes(i, parent(i));
+            i = parent(i);
+        }
+    }
+
+    void heapifyDown(int i) {
+        int extreme = i; 
+        int l = left(i);
+        int r = right(i);
+
+        if (l < heap.size() && compare(heap[l], heap[extreme])) extreme = l;
+        if (r < heap.size() && compare(heap[r], heap[extreme])) extreme = r;
+
+        if (extreme != i) {
+            swapNodes(i, extreme);
+            heapifyDown(extreme);
+        }
+    }
+
+    vector<LogStep> logs;
+
+public:
+    HeapBackend() : isMinHeap(true), stats(), timingEnabled(false) {}
+
+    void setMode(bool minMode) {
+        isMinHeap = minMode;
+        heap.clear();
+    }
+
+    vector<LogStep> insert(int key) {
+        perf::ScopedCallTimer timer(stats.timing, timingEnabled);
+        logs.clear();
+        if (heap.size() == heap.capacity()) stats.allocations++;
+        heap.push_back(key);
+        int index = heap.size() - 1;
+        logs.push_back({"insert", index, key, "Inserted"});
+        heapifyUp(index);
+        logs.push_back({"complete", -1, -1, "Done"});
+        return logs;
+    }
+
+    vector<LogStep> extract() {
+        perf::ScopedCallTimer timer(stats.timing, timingEnabled);
+        logs.clear();
+        if (heap.size() == 0) return logs;
+
+        int lastIndex = heap.size() - 1;
+        logs.push_back({"highlight", 0, lastIndex, "Swap Root with Last"});
+        
+        int rootVal = heap[0];
+        heap[0] = heap[lastIndex];
+        heap[lastIndex] = rootVal;
+        stats.swaps++;
+        logs.push_back({"swap", 0, lastIndex, "Removing Root"});
+
+        logs.push_back({"extract", lastIndex, rootVal, "Extracted"});
+        heap.pop_back();
+
+        if (heap.size() > 0) heapifyDown(0);
+        
+        logs.push_back({"complete", -1, -1, "Done"});
+        return logs;
+    }
+
+    vector<int> getArray() { return heap; }
+
+    vector<uint8_t> saveSnapshot() {
+        snapshot::Writer w;
+        w.reserve(1 + heap.size());
+        w.put((int32_t)heap.size());
+        for (int v : heap) w.put(v);
+        return w.finish(snapshot::HEAP_ARRAY, isMinHeap ? SNAPSHOT_MIN_HEAP : 0);
+    }
+
+    // Replaces the heap (and its mode) with the snapshot's. Leaves the heap
+    // untouched and returns false if the buffer is not a valid heap snapshot.
+    bool loadSnapshot(const uint8_t* data, size_t len) {
+        const snapshot::Header* h = snapshot::validate(data, len, snapshot::HEAP_ARRAY);
+        if (h == nullptr || snapshot::payloadInts(h) < 1) return false;
+        const int32_t* p = snapshot::payload(h);
+        int32_t count = p[0];
+        if (count < 0 || snapshot::payloadInts(h) != 1 + (uint64_t)count) return false;
+
+        const int32_t* values = p + 1;
+        bool minMode = (h->flags & SNAPSHOT_MIN_HEAP) != 0;
+        for (int32_t i = 1; i < count; i++) {
+            int32_t par = (i - 1) / 2;
+            if (minMode ? values[i] < values[par] : values[i] > values[par]) return false;
+        }
+
+        isMinHeap = minMode;
+        if ((size_t)count > heap.capacity()) stats.allocations++;
+        heap.assign(values, values + count);
+        return true;
+    }
+
+    Stats getStats() {
+        Stats s = stats;
+        s.bytesLive = (double)heap.capacity() * sizeof(int);
+        return s;
+    }
+
+    void resetStats() {
+        stats = Stats();
+    }
+
+    void setTiming(bool enabled) {
+        timingEnabled = enabled;
+    }
+};
+
+} // namespace heap_core
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+
+// Shared pieces of the getStats()/resetStats() surface every backend exposes.
+// Counters are doubles so embind can hand them to JS without BigInt; they
+// stay exact up to 2^53.
+namespace perf {
+
+struct CallTiming {
+    double calls;   // public operations, always counted
+    double totalNs; // only accumulated while timing is enabled
+    double maxNs;
+};
+
+// Counts one public call and, when enabled, times it into `timing`.
+// Disabled timers never touch the clock, so counting stays a single add.
+class ScopedCallTimer {
+private:
+    CallTiming& timing;
+    bool enabled;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    ScopedCallTimer(CallTiming& t, bool timingEnabled) : timing(t), enabled(timingEnabled) {
+        timing.calls++;
+        if (enabled) start = std::chrono::steady_clock::now();
+    }
+
+    ~ScopedCallTimer() {
+        if (!enabled) return;
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        timing.totalNs += ns;
+        if (ns > timing.maxNs) timing.maxNs = ns;
+    }
+};
+
+} // namespace perf
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// Flat binary snapshots shared by every backend's saveSnapshot()/loadSnapshot().
+//
+// Layout: a 32-byte Header followed by a payload made only of int32 values
+// (native little-endian, which covers wasm and every target we build for).
+// Because nothing in the payload is a pointer, a native build can mmap a
+// snapshot file and read it in place through the per-backend views.
+namespace snapshot {
+
+const uint32_t VERSION = 1;
+
+enum Kind : uint32_t {
+    AVL_ARENA = 1,    // preorder node arena: {key, height, left, right}
+    HEAP_ARRAY = 2,   // the heap array as-is
+    GRAPH_CSR = 3,    // vertex ids, row offsets, targets, weights
+    HASH_BUCKETS = 4, // bucket offsets, then keys in chain order
+};
+
+struct Header {
+    char magic[4];         // "AVSN"
+    uint32_t version;
+    uint32_t kind;
+    uint32_t flags;        // backend-specific (e.g. heap min/max mode)
+    uint64_t payloadBytes;
+    uint32_t checksum;     // FNV-1a over the payload
+    uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 32, "snapshot header must stay 32 bytes");
+
+inline uint32_t checksum(const uint8_t* data, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= data[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Builds a snapshot: reserve() once, put() the payload, then finish().
+class Writer {
+private:
+    std::vector<uint8_t> buf;
+
+public:
+    Writer() : buf(sizeof(Header)) {}
+
+    void reserve(size_t payloadInts) {
+        buf.reserve(sizeof(Header) + payloadInts * sizeof(int32_t));
+    }
+
+    void put(int32_t v) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&v);
+        buf.insert(buf.end(), bytes, bytes + sizeof(int32_t));
+    }
+
+    std::vector<uint8_t> finish(uint32_t kind, uint32_t flags) {
+        Header h;
+        memcpy(h.magic, "AVSN", 4);
+        h.version = VERSION;
+        h.kind = kind;
+        h.flags = flags;
+        h.payloadBytes = buf.size() - sizeof(Header);
+        h.checksum = checksum(buf.data() + sizeof(Header), h.payloadBytes);
+        h.reserved = 0;
+        memcpy(buf.data(), &h, sizeof(Header));
+        return std::move(buf);
+    }
+};
+
+// Returns the header if `data` is an intact snapshot of the given kind,
+// nullptr otherwise, including when `data` is not 8-byte aligned (mmap and
+// malloc both are; an offset into a larger buffer may not be).
+inline const Header* validate(const uint8_t* data, size_t len, uint32_t kind) {
+    if (data == nullptr || len < sizeof(Header)) return nullptr;
+    if (reinterpret_cast<uintptr_t>(data) % alignof(Header) != 0) return nullptr;
+    const Header* h = reinterpret_cast<const Header*>(data);
+    if (memcmp(h->magic, "AVSN", 4) != 0) return nullptr;
+    if (h->version != VERSION || h->kind != kind) return nullptr;
+    if (h->payloadBytes != len - sizeof(Header)) return nullptr;
+    if (h->payloadBytes % sizeof(int32_t) != 0) return nullptr;
+    if (h->checksum != checksum(data + sizeof(Header), h->payloadBytes)) return nullptr;
+    return h;
+}
+
+inline const int32_t* payload(const Header* h) {
+    return reinterpret_cast<const int32_t*>(h + 1);
+}
+
+inline size_t payloadInts(const Header* h) {
+    return h->payloadBytes / sizeof(int32_t);
+}
+
+} // namespace snapshot